@@ -2,12 +2,13 @@
 
 set -x
 
-g++ -std=c++17 -Wall -Wpedantic src/main.cpp src/SparseMatrix.cpp src/SparseMatrixCOO.cpp src/SparseMatrixCSR.cpp -o sparse_matrix
+g++ -std=c++17 -Wall -Wpedantic src/main.cpp src/SparseMatrix.cpp src/SparseMatrixCOO.cpp src/SparseMatrixCSR.cpp src/SparseMatrixCompressedCSR.cpp -o sparse_matrix
+g++ -std=c++17 -O2 -DNDEBUG -Wall -Wpedantic src/benchmark.cpp src/SparseMatrix.cpp src/SparseMatrixCOO.cpp src/SparseMatrixCSR.cpp src/SparseMatrixCompressedCSR.cpp -o sparse_matrix_benchmark
 
 set +x
 
 if [ $? -eq 0 ]; then
-    echo "Build successful! You can run the program using ./sparse_matrix"
+    echo "Build successful! You can run the program using ./sparse_matrix and the benchmark using ./sparse_matrix_benchmark"
 else
     echo "Build failed."
 fi
\ No newline at end of file
@@ -22,12 +22,29 @@ public:
 
     virtual T &operator()(const unsigned int &row_coordinate, const unsigned int &col_coordinate) = 0;
 
-    std::vector<T> operator*(const std::vector<T> &v) const;
+    virtual std::vector<T> operator*(const std::vector<T> &v) const;
+
+    // all the cells, row by row (what operator<< prints for small matrices);
+    // numbers follow the precision and the std::fixed, std::scientific or std::hexfloat flags of os
+    void print_dense(std::ostream &os) const;
+
+    // only the stored elements, in Matrix Market coordinate format (1-based indexes)
+    void print_sparse(std::ostream &os) const;
+
+    // dimensions, number of nonzero elements and histogram of the row lengths
+    void print_summary(std::ostream &os) const;
+
+    // operator<< prints the summary instead of the dense matrix above this number of cells
+    constexpr static unsigned long long PRINT_DENSE_MAX_CELLS = 10000;
 
     template <typename U> // friend function needs its own template
     friend std::ostream &operator<<(std::ostream &os, const SparseMatrix<U> &m);
 
 protected:
+    // points row_cols and row_values to the stored elements of a row (0-based), sorted by column,
+    // and returns how many they are
+    virtual unsigned int get_row(const unsigned int &row, const unsigned int *&row_cols, const T *&row_values) const = 0;
+
     unsigned int n_rows;
     unsigned int n_cols;
     constexpr static T ZERO = 0; // constant to be returned as reference in the reading operator()
@@ -10,6 +10,9 @@ template <typename T>
 class SparseMatrixCOO : public SparseMatrix<T>
 {
 public:
+    // Elements must be sorted by row and, inside each row, by column (checked with assert):
+    // the methods rely on this order, e.g. get_row() and to_CSR() look for each row in a contiguous range
+
     // Constructor (number of rows and columns iferred by the other parameters)
     SparseMatrixCOO(const std::vector<T> &input_values,
                     const std::vector<unsigned int> &input_rows,
@@ -37,7 +40,13 @@ public:
 
     SparseMatrixCSR<T> to_CSR() const;
 
+protected:
+    unsigned int get_row(const unsigned int &row, const unsigned int *&row_cols, const T *&row_values) const override;
+
 private:
+    // true if the elements are sorted by row and then by column, without duplicates
+    bool is_sorted() const;
+
     std::vector<T> values;
     std::vector<unsigned int> rows;
     std::vector<unsigned int> cols;
@@ -3,6 +3,9 @@
 
 #include "SparseMatrixCOO.hpp" // included for the to_COO() method
 
+template <typename T>
+class SparseMatrixCompressedCSR; // forward declaration of SparseMatrixCompressedCSR for the to_compressed() method
+
 template <typename T>
 class SparseMatrixCSR : public SparseMatrix<T>
 {
@@ -32,8 +35,21 @@ public:
 
     T &operator()(const unsigned int &row_coordinate, const unsigned int &col_coordinate) override;
 
+    std::vector<T> operator*(const std::vector<T> &v) const override;
+
+    // same as operator*, writing in result (which must have n_rows elements) instead of allocating it
+    void multiply(const std::vector<T> &v, std::vector<T> &result) const;
+
+    // number of bytes used by the stored arrays
+    std::size_t get_size_in_bytes() const;
+
     SparseMatrixCOO<T> to_COO() const;
 
+    SparseMatrixCompressedCSR<T> to_compressed() const;
+
+protected:
+    unsigned int get_row(const unsigned int &row, const unsigned int *&row_cols, const T *&row_values) const override;
+
 private:
     std::vector<T> values;
     std::vector<unsigned int> cols;
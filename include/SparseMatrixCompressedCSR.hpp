@@ -0,0 +1,68 @@
+#ifndef SPARSE_MATRIX_COMPRESSED_CSR_HPP_
+#define SPARSE_MATRIX_COMPRESSED_CSR_HPP_
+
+#include "SparseMatrixCSR.hpp" // included for the to_compressed() method
+
+// Read-only CSR variant that stores fewer bytes per nonzero, meant for bandwidth-bound products:
+// - in each row, the first column index is stored as a varint (7 bits per byte) and the others as the
+//   distance from the previous one, all with the same width: 8, 16 or 24 bits, or varints for bigger distances
+// - values are stored only once when the matrix has few distinct values
+template <typename T>
+class SparseMatrixCompressedCSR
+{
+public:
+    // how the values are stored
+    enum class ValueEncoding
+    {
+        RAW,        // one value per nonzero element, like plain CSR
+        DICTIONARY, // at most 256 distinct values, one byte per nonzero element
+        PATTERN     // a single distinct value (e.g. unit weights), no per-element storage
+    };
+
+    // Constructor (same parameters as the 5-parameters constructor of SparseMatrixCSR)
+    SparseMatrixCompressedCSR(const std::vector<T> &input_values,
+                              const std::vector<unsigned int> &input_cols,
+                              const std::vector<unsigned int> &input_row_idx,
+                              const unsigned int input_n_rows, const unsigned int input_n_cols);
+
+    // Implicit copy constructor, assignment operator and destructor are sufficient for vectors
+
+    unsigned int get_n_rows() const { return n_rows; }
+
+    unsigned int get_n_cols() const { return n_cols; }
+
+    unsigned int get_nnz() const { return row_idx[n_rows]; }
+
+    ValueEncoding get_value_encoding() const { return encoding; }
+
+    // number of bytes used by the stored arrays (all of them are read by the matrix-vector product)
+    std::size_t get_size_in_bytes() const;
+
+    // reading only: the compressed storage can't hand out writable references;
+    // rows have no index in col_bytes, so the ones before the target row are skipped one by one
+    const T &operator()(const unsigned int &row_coordinate, const unsigned int &col_coordinate) const;
+
+    // matrix-vector product, decoding the columns and values on the fly
+    std::vector<T> operator*(const std::vector<T> &v) const;
+
+    // same as operator*, writing in result (which must have n_rows elements) instead of allocating it
+    void multiply(const std::vector<T> &v, std::vector<T> &result) const;
+
+    SparseMatrixCSR<T> to_CSR() const;
+
+private:
+    // runs the product using value_at(k) to get the value of the k-th nonzero element
+    template <typename ValueAt>
+    void multiply_rows(const std::vector<T> &v, std::vector<T> &result, ValueAt value_at) const;
+
+    unsigned int n_rows;
+    unsigned int n_cols;
+    ValueEncoding encoding;
+    std::vector<unsigned int> row_idx;    // same as in CSR: index of the first element of each row
+    std::vector<unsigned char> col_bytes; // encoded columns, one row after the other
+    std::vector<T> values;                // all values (RAW), distinct values (DICTIONARY) or the single value (PATTERN)
+    std::vector<unsigned char> value_ids; // position in values of each nonzero element (DICTIONARY only)
+    constexpr static T ZERO = 0;          // constant to be returned as reference in the reading operator()
+};
+
+#endif
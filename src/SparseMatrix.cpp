@@ -1,7 +1,10 @@
 #include "../include/SparseMatrix.hpp"
 #include <algorithm>
 #include <cassert>
+#include <charconv>
+#include <cmath>
 #include <string>
+#include <type_traits>
 
 template <typename T>
 std::vector<T> SparseMatrix<T>::operator*(const std::vector<T> &v) const
@@ -22,48 +25,217 @@ std::vector<T> SparseMatrix<T>::operator*(const std::vector<T> &v) const
     return result;
 }
 
-template <typename U>
-std::ostream &operator<<(std::ostream &os, const SparseMatrix<U> &m)
+// size of the buffer where a single number is formatted
+// (enough for any double in fixed notation with the maximum precision below)
+constexpr unsigned int FORMAT_BUFFER_SIZE = 512;
+
+// maximum number of digits after the point (or significant digits for %g) that are printed
+constexpr int FORMAT_MAX_PRECISION = 100;
+
+// writes value in buffer (without allocating) and returns the number of characters used;
+// a negative precision gives the shortest representation that reads back to the same value
+// (choosing between fixed and scientific notation by itself when format is general)
+template <typename T>
+unsigned int format_value(char *buffer, const T &value, const std::chars_format &format, const int &precision)
+{
+    std::to_chars_result result;
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        if (format == std::chars_format::hex && std::isfinite(value)) // streams write 0x after the sign
+        {
+            char *start = buffer;
+            if (std::signbit(value))
+            {
+                *start++ = '-';
+            }
+            *start++ = '0';
+            *start++ = 'x';
+            result = std::to_chars(start, buffer + FORMAT_BUFFER_SIZE, std::abs(value), format);
+        }
+        else if (precision >= 0)
+        {
+            result = std::to_chars(buffer, buffer + FORMAT_BUFFER_SIZE, value, format, std::min(precision, FORMAT_MAX_PRECISION));
+        }
+        else if (format != std::chars_format::general)
+        {
+            result = std::to_chars(buffer, buffer + FORMAT_BUFFER_SIZE, value, format);
+        }
+        else
+        {
+            result = std::to_chars(buffer, buffer + FORMAT_BUFFER_SIZE, value);
+        }
+    }
+    else
+    {
+        result = std::to_chars(buffer, buffer + FORMAT_BUFFER_SIZE, value);
+    }
+    return result.ptr - buffer;
+}
+
+// format and precision that give the same text as os << value for floating point numbers
+void stream_float_format(const std::ostream &os, std::chars_format &format, int &precision)
+{
+    precision = os.precision();
+    switch (os.flags() & std::ios_base::floatfield)
+    {
+    case std::ios_base::fixed:
+        format = std::chars_format::fixed;
+        break;
+    case std::ios_base::scientific:
+        format = std::chars_format::scientific;
+        break;
+    case std::ios_base::fixed | std::ios_base::scientific: // std::hexfloat ignores the precision
+        format = std::chars_format::hex;
+        precision = -1;
+        break;
+    default: // %g uses at least one digit
+        format = std::chars_format::general;
+        precision = std::max(precision, 1);
+    }
+}
+
+template <typename T>
+void SparseMatrix<T>::print_dense(std::ostream &os) const
 {
-    // find the max length of the to-be-displayed numbers (for the formatting)
-    unsigned int max_len = 0;
-    unsigned int current_len = 0;
-    std::string s;
+    std::chars_format format;
+    int precision;
+    stream_float_format(os, format, precision);
+    char buffer[FORMAT_BUFFER_SIZE + 1]; // a whole cell: the number and at least one space
+    const unsigned int *row_cols;
+    const T *row_values;
 
-    for (unsigned int i = 0; i < m.n_rows; ++i)
+    // zeros are formatted like the other numbers (e.g. "0.000" with std::fixed)
+    const unsigned int zero_len = format_value(buffer, ZERO, format, precision);
+    const std::string zero(buffer, zero_len);
+
+    // find the max length of the to-be-displayed numbers (for the formatting), looking only at the stored ones
+    unsigned int max_len = zero_len;
+    for (unsigned int i = 0; i < n_rows; ++i)
     {
-        for (unsigned int j = 0; j < m.n_cols; ++j)
+        unsigned int row_nnz = get_row(i, row_cols, row_values);
+        for (unsigned int k = 0; k < row_nnz; ++k)
         {
-            s = std::to_string(m(i + 1, j + 1));
-            s.erase(s.find_last_not_of('0') + 1, std::string::npos); // delete unnecessary zeros added by to_string
-            current_len = s.length();
-            max_len = std::max(max_len, current_len);
+            max_len = std::max(max_len, format_value(buffer, row_values[k], format, precision));
         }
     }
     ++max_len; // numbers must be separated by one space
 
+    // a row full of zeros is used as starting point for every row
+    std::string zero_row;
+    for (unsigned int j = 0; j < n_cols; ++j)
+    {
+        zero_row += zero;
+        zero_row.append(max_len - zero_len, ' ');
+    }
+
     // the user is expected to put the endline at the start and at the end
-    for (unsigned int i = 0; i < m.n_rows; ++i)
+    std::string line;
+    for (unsigned int i = 0; i < n_rows; ++i)
     {
         if (i != 0) // first row doesn't have an endline at the start
         {
-            os << std::endl;
+            os << '\n';
         }
-        for (unsigned int j = 0; j < m.n_cols; ++j)
+        line = zero_row; // same size for every row, so no allocation after the first one
+        unsigned int row_nnz = get_row(i, row_cols, row_values);
+        for (unsigned int k = 0; k < row_nnz; ++k)
         {
-            s = std::to_string(m(i + 1, j + 1));
-            s.erase(s.find_last_not_of('0') + 1, std::string::npos); // for integers, this leaves a final "."
-            current_len = s.length();
-            os << m(i + 1, j + 1);
-            for (unsigned int k = 0; k < max_len - current_len; ++k) // add formatting spaces
-            {
-                os << " ";
-            }
-            if (s.find_last_of(".") + 1 == s.length()) // add missing space for integers (final "." counts in current_len)
-            {
-                os << " ";
-            }
+            // the whole cell is written, since the number can be shorter than the zero it replaces
+            unsigned int len = format_value(buffer, row_values[k], format, precision);
+            std::fill(buffer + len, buffer + max_len, ' ');
+            line.replace(row_cols[k] * max_len, max_len, buffer, max_len);
+        }
+        os.write(line.data(), line.size());
+    }
+}
+
+template <typename T>
+void SparseMatrix<T>::print_sparse(std::ostream &os) const
+{
+    char buffer[3 * FORMAT_BUFFER_SIZE];
+    const unsigned int *row_cols;
+    const T *row_values;
+
+    os << "%%MatrixMarket matrix coordinate " << (std::is_floating_point_v<T> ? "real" : "integer") << " general"
+       << '\n'
+       << n_rows << ' ' << n_cols << ' ' << get_nnz();
+
+    // the user is expected to put the endline at the end
+    for (unsigned int i = 0; i < n_rows; ++i)
+    {
+        unsigned int row_nnz = get_row(i, row_cols, row_values);
+        for (unsigned int k = 0; k < row_nnz; ++k)
+        {
+            // each line is "row col value", all formatted in the same buffer
+            char *end = buffer;
+            *end++ = '\n';
+            end += format_value(end, i + 1, std::chars_format::general, -1);
+            *end++ = ' ';
+            end += format_value(end, row_cols[k] + 1, std::chars_format::general, -1);
+            *end++ = ' ';
+            end += format_value(end, row_values[k], std::chars_format::general, -1); // shortest exact representation
+            os.write(buffer, end - buffer);
+        }
+    }
+}
+
+template <typename T>
+void SparseMatrix<T>::print_summary(std::ostream &os) const
+{
+    const unsigned int *row_cols;
+    const T *row_values;
+
+    // row lengths are grouped in powers of 2: 0, 1, 2-3, 4-7, 8-15, ...
+    std::vector<unsigned int> histogram;
+    for (unsigned int i = 0; i < n_rows; ++i)
+    {
+        unsigned int row_nnz = get_row(i, row_cols, row_values);
+        unsigned int bucket = 0;
+        while (row_nnz >> bucket) // number of binary digits of row_nnz
+        {
+            ++bucket;
+        }
+        if (bucket >= histogram.size())
+        {
+            histogram.resize(bucket + 1, 0);
+        }
+        ++histogram[bucket];
+    }
+
+    // the user is expected to put the endline at the start and at the end
+    os << n_rows << " x " << n_cols << " sparse matrix with " << get_nnz() << " nonzero elements" << '\n'
+       << "rows by number of nonzero elements:";
+    for (unsigned int bucket = 0; bucket < histogram.size(); ++bucket)
+    {
+        if (histogram[bucket] == 0)
+        {
+            continue;
+        }
+        os << '\n'
+           << "    ";
+        if (bucket <= 1) // 0 and 1 are single values
+        {
+            os << bucket;
+        }
+        else
+        {
+            os << (1ull << (bucket - 1)) << '-' << (1ull << bucket) - 1;
         }
+        os << ": " << histogram[bucket];
+    }
+}
+
+template <typename U>
+std::ostream &operator<<(std::ostream &os, const SparseMatrix<U> &m)
+{
+    // big matrices would take too long to print (and to read), so only their summary is shown
+    if (static_cast<unsigned long long>(m.n_rows) * m.n_cols > SparseMatrix<U>::PRINT_DENSE_MAX_CELLS)
+    {
+        m.print_summary(os);
+    }
+    else
+    {
+        m.print_dense(os);
     }
     return os;
 }
@@ -1,4 +1,5 @@
 #include "../include/SparseMatrixCSR.hpp" // CSR instead of COO to avoid circular dependency
+#include <algorithm>
 #include <cassert>
 
 // Constructor
@@ -8,6 +9,7 @@ SparseMatrixCOO<T>::SparseMatrixCOO(const std::vector<T> &input_values,
                                     const std::vector<unsigned int> &input_cols)
     : values(input_values), rows(input_rows), cols(input_cols)
 {
+    assert(is_sorted());
     this->n_rows = rows[rows.size() - 1] + 1; // the last element contains the index of the last row; +1 because it's 0-based
 
     unsigned int max = cols[0];
@@ -29,6 +31,7 @@ SparseMatrixCOO<T>::SparseMatrixCOO(const std::vector<T> &input_values,
                                     const unsigned int input_n_rows, const unsigned int input_n_cols)
     : values(input_values), rows(input_rows), cols(input_cols)
 {
+    assert(is_sorted());
     this->n_rows = input_n_rows;
     this->n_cols = input_n_cols;
 }
@@ -132,6 +135,30 @@ T &SparseMatrixCOO<T>::operator()(const unsigned int &row_coordinate, const unsi
     return values[values.size() - 1];
 }
 
+template <typename T>
+bool SparseMatrixCOO<T>::is_sorted() const
+{
+    for (unsigned int i = 1; i < rows.size(); ++i)
+    {
+        if (rows[i] < rows[i - 1] || (rows[i] == rows[i - 1] && cols[i] <= cols[i - 1]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T>
+unsigned int SparseMatrixCOO<T>::get_row(const unsigned int &row, const unsigned int *&row_cols, const T *&row_values) const
+{
+    // elements are sorted by row, so the ones of the target row are contiguous
+    auto range = std::equal_range(rows.begin(), rows.end(), row);
+    unsigned int first = range.first - rows.begin();
+    row_cols = cols.data() + first;
+    row_values = values.data() + first;
+    return range.second - range.first;
+}
+
 template <typename T>
 SparseMatrixCSR<T> SparseMatrixCOO<T>::to_CSR() const
 {
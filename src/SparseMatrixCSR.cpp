@@ -1,4 +1,4 @@
-#include "../include/SparseMatrixCSR.hpp"
+#include "../include/SparseMatrixCompressedCSR.hpp" // instead of CSR to avoid circular dependency
 #include <cassert>
 
 // Constructor
@@ -147,6 +147,46 @@ T &SparseMatrixCSR<T>::operator()(const unsigned int &row_coordinate, const unsi
     return values[row_idx[row + 1] - 1];
 }
 
+template <typename T>
+std::vector<T> SparseMatrixCSR<T>::operator*(const std::vector<T> &v) const
+{
+    std::vector<T> result(this->n_rows, 0);
+    multiply(v, result);
+    return result;
+}
+
+template <typename T>
+void SparseMatrixCSR<T>::multiply(const std::vector<T> &v, std::vector<T> &result) const
+{
+    // vectors must be of compatible size
+    assert(v.size() == this->n_cols && result.size() == this->n_rows);
+
+    // only the stored elements contribute to the result
+    for (unsigned int i = 0; i < this->n_rows; ++i)
+    {
+        T sum = 0;
+        for (unsigned int j = row_idx[i]; j < row_idx[i + 1]; ++j)
+        {
+            sum = sum + values[j] * v[cols[j]];
+        }
+        result[i] = sum;
+    }
+}
+
+template <typename T>
+std::size_t SparseMatrixCSR<T>::get_size_in_bytes() const
+{
+    return values.size() * sizeof(T) + (cols.size() + row_idx.size()) * sizeof(unsigned int);
+}
+
+template <typename T>
+unsigned int SparseMatrixCSR<T>::get_row(const unsigned int &row, const unsigned int *&row_cols, const T *&row_values) const
+{
+    row_cols = cols.data() + row_idx[row];
+    row_values = values.data() + row_idx[row];
+    return row_idx[row + 1] - row_idx[row];
+}
+
 template <typename T>
 SparseMatrixCOO<T> SparseMatrixCSR<T>::to_COO() const
 {
@@ -164,6 +204,13 @@ SparseMatrixCOO<T> SparseMatrixCSR<T>::to_COO() const
     return converted;
 }
 
+template <typename T>
+SparseMatrixCompressedCSR<T> SparseMatrixCSR<T>::to_compressed() const
+{
+    SparseMatrixCompressedCSR<T> converted(values, cols, row_idx, this->n_rows, this->n_cols);
+    return converted;
+}
+
 // explicit instantiation for the class using int and double
 template class SparseMatrixCSR<int>;
 template class SparseMatrixCSR<double>;
\ No newline at end of file
@@ -0,0 +1,417 @@
+#include "../include/SparseMatrixCompressedCSR.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+
+// width of the column distances of a row (the first byte of every row with at least two elements)
+enum ColumnWidth : unsigned char
+{
+    COLUMNS_8 = 0,
+    COLUMNS_16 = 1,
+    COLUMNS_24 = 2,
+    COLUMNS_VARINT = 3 // used only when some distance doesn't fit in 24 bits
+};
+
+// number of bytes of each distance for the fixed widths
+inline unsigned int width_bytes(const unsigned char width)
+{
+    return width + 1;
+}
+
+// appends value as a varint: 7 bits per byte, the highest bit tells that more bytes follow
+void write_varint(std::vector<unsigned char> &bytes, unsigned int value)
+{
+    while (value >= 0x80)
+    {
+        bytes.push_back(static_cast<unsigned char>(value | 0x80));
+        value >>= 7;
+    }
+    bytes.push_back(static_cast<unsigned char>(value));
+}
+
+// reads a varint starting at byte and moves byte after it
+inline unsigned int read_varint(const unsigned char *&byte)
+{
+    unsigned int value = 0;
+    unsigned int shift = 0;
+    while (*byte & 0x80)
+    {
+        value |= static_cast<unsigned int>(*byte++ & 0x7F) << shift;
+        shift += 7;
+    }
+    value |= static_cast<unsigned int>(*byte++) << shift;
+    return value;
+}
+
+// decodes the columns of a row with row_nnz elements starting at byte, calling visit(k, col) for
+// the k-th element of the row, and moves byte to the start of the next row
+template <typename Visit>
+inline void decode_row(const unsigned char *&byte, const unsigned int row_nnz, Visit visit)
+{
+    if (row_nnz == 0)
+    {
+        return;
+    }
+    unsigned char width = row_nnz > 1 ? *byte++ : COLUMNS_8;
+    unsigned int col = read_varint(byte);
+    visit(0, col);
+
+    // fixed widths have no dependency between the reads, so these loops can be unrolled
+    const unsigned char *distances = byte; // local copy, so the loops don't go through the reference
+    if (width == COLUMNS_8)
+    {
+        for (unsigned int k = 1; k < row_nnz; ++k)
+        {
+            col += distances[k - 1];
+            visit(k, col);
+        }
+    }
+    else if (width == COLUMNS_16)
+    {
+        for (unsigned int k = 1; k < row_nnz; ++k, distances += 2)
+        {
+            col += distances[0] | static_cast<unsigned int>(distances[1]) << 8; // little-endian
+            visit(k, col);
+        }
+    }
+    else if (width == COLUMNS_24)
+    {
+        for (unsigned int k = 1; k < row_nnz; ++k, distances += 3)
+        {
+            col += distances[0] | static_cast<unsigned int>(distances[1]) << 8 | static_cast<unsigned int>(distances[2]) << 16;
+            visit(k, col);
+        }
+    }
+    else
+    {
+        for (unsigned int k = 1; k < row_nnz; ++k)
+        {
+            col += read_varint(byte);
+            visit(k, col);
+        }
+        return;
+    }
+    byte += width_bytes(width) * (row_nnz - 1);
+}
+
+// moves byte to the start of the next row without decoding the columns (except for varint rows)
+inline void skip_row(const unsigned char *&byte, const unsigned int row_nnz)
+{
+    if (row_nnz == 0)
+    {
+        return;
+    }
+    unsigned char width = row_nnz > 1 ? *byte++ : COLUMNS_8;
+    read_varint(byte);
+    if (width == COLUMNS_VARINT)
+    {
+        for (unsigned int k = 1; k < row_nnz; ++k)
+        {
+            read_varint(byte);
+        }
+    }
+    else
+    {
+        byte += width_bytes(width) * (row_nnz - 1);
+    }
+}
+
+// bit pattern of value, used to compare values exactly (NaN equal to itself, -0.0 different from +0.0)
+template <typename T>
+inline std::uint64_t bits_of(const T &value)
+{
+    static_assert(sizeof(T) <= sizeof(std::uint64_t), "values must fit in 64 bits");
+    std::uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(T));
+    return bits;
+}
+
+// Constructor
+template <typename T>
+SparseMatrixCompressedCSR<T>::SparseMatrixCompressedCSR(const std::vector<T> &input_values,
+                                                        const std::vector<unsigned int> &input_cols,
+                                                        const std::vector<unsigned int> &input_row_idx,
+                                                        const unsigned int input_n_rows, const unsigned int input_n_cols)
+    : n_rows(input_n_rows), n_cols(input_n_cols), row_idx(input_row_idx)
+{
+    assert(row_idx.size() == n_rows + 1 && row_idx[n_rows] == input_values.size());
+
+    // encode the columns: the first one of each row as is, the others as the distance from the previous one
+    col_bytes.reserve(input_cols.size()); // about one byte per element
+    for (unsigned int i = 0; i < n_rows; ++i)
+    {
+        if (row_idx[i + 1] == row_idx[i]) // nothing is stored for empty rows
+        {
+            continue;
+        }
+
+        // the biggest distance decides the width of the whole row
+        unsigned int max_delta = 0;
+        for (unsigned int j = row_idx[i] + 1; j < row_idx[i + 1]; ++j)
+        {
+            assert(input_cols[j] > input_cols[j - 1]); // columns must be sorted inside each row
+            max_delta = std::max(max_delta, input_cols[j] - input_cols[j - 1]);
+        }
+        unsigned char width = COLUMNS_VARINT;
+        if (max_delta <= 0xFF)
+        {
+            width = COLUMNS_8;
+        }
+        else if (max_delta <= 0xFFFF)
+        {
+            width = COLUMNS_16;
+        }
+        else if (max_delta <= 0xFFFFFF)
+        {
+            width = COLUMNS_24;
+        }
+        if (row_idx[i + 1] - row_idx[i] > 1) // single-element rows have no distances
+        {
+            col_bytes.push_back(width);
+        }
+
+        write_varint(col_bytes, input_cols[row_idx[i]]);
+        for (unsigned int j = row_idx[i] + 1; j < row_idx[i + 1]; ++j)
+        {
+            unsigned int delta = input_cols[j] - input_cols[j - 1];
+            if (width == COLUMNS_VARINT)
+            {
+                write_varint(col_bytes, delta);
+            }
+            else
+            {
+                for (unsigned int b = 0; b < width_bytes(width); ++b) // little-endian
+                {
+                    col_bytes.push_back(static_cast<unsigned char>(delta >> (8 * b)));
+                }
+            }
+        }
+    }
+
+    // collect the distinct values, giving up as soon as there are too many for the dictionary;
+    // they are compared by bit pattern, since operator< has no consistent order with NaN
+    std::vector<std::uint64_t> distinct;
+    for (const T &value : input_values)
+    {
+        std::uint64_t bits = bits_of(value);
+        auto position = std::lower_bound(distinct.begin(), distinct.end(), bits);
+        if (position == distinct.end() || *position != bits)
+        {
+            if (distinct.size() == 256) // ids must fit in one byte
+            {
+                distinct.clear();
+                break;
+            }
+            distinct.insert(position, bits);
+        }
+    }
+
+    // values in the same order as distinct
+    std::vector<T> distinct_values(distinct.size());
+    for (unsigned int i = 0; i < distinct.size(); ++i)
+    {
+        std::memcpy(&distinct_values[i], &distinct[i], sizeof(T));
+    }
+
+    const std::size_t nnz = input_values.size();
+    if (nnz == 0 || distinct.size() == 1)
+    {
+        encoding = ValueEncoding::PATTERN;
+        values = distinct_values;
+    }
+    else if (!distinct.empty() && distinct.size() * sizeof(T) + nnz < nnz * sizeof(T)) // only if it saves space
+    {
+        encoding = ValueEncoding::DICTIONARY;
+        values = distinct_values;
+        value_ids.reserve(nnz);
+        for (const T &value : input_values)
+        {
+            // distinct is sorted, so the id is found with a binary search
+            value_ids.push_back(std::lower_bound(distinct.begin(), distinct.end(), bits_of(value)) - distinct.begin());
+        }
+    }
+    else
+    {
+        encoding = ValueEncoding::RAW;
+        values = input_values;
+    }
+}
+
+template <typename T>
+std::size_t SparseMatrixCompressedCSR<T>::get_size_in_bytes() const
+{
+    return values.size() * sizeof(T) + row_idx.size() * sizeof(unsigned int) + col_bytes.size() + value_ids.size();
+}
+
+template <typename T>
+const T &SparseMatrixCompressedCSR<T>::operator()(const unsigned int &row_coordinate, const unsigned int &col_coordinate) const
+{
+    // check if coordinates are out of bounds
+    assert(row_coordinate != 0 && col_coordinate != 0 && row_coordinate <= n_rows && col_coordinate <= n_cols);
+
+    // adjust to 0-based indexing
+    unsigned int row = row_coordinate - 1;
+    unsigned int col = col_coordinate - 1;
+
+    const unsigned char *byte = col_bytes.data();
+    for (unsigned int i = 0; i < row; ++i) // reach the target row
+    {
+        skip_row(byte, row_idx[i + 1] - row_idx[i]);
+    }
+
+    const T *found = &ZERO; // if there is no match, return 0
+    decode_row(byte, row_idx[row + 1] - row_idx[row], [&](unsigned int k, unsigned int current)
+               {
+                   if (current == col) // if a match is found, return corresponding value
+                   {
+                       unsigned int i = row_idx[row] + k;
+                       switch (encoding)
+                       {
+                       case ValueEncoding::RAW:
+                           found = &values[i];
+                           break;
+                       case ValueEncoding::DICTIONARY:
+                           found = &values[value_ids[i]];
+                           break;
+                       case ValueEncoding::PATTERN:
+                           found = &values[0];
+                           break;
+                       }
+                   } });
+    return *found;
+}
+
+template <typename T>
+template <typename ValueAt>
+void SparseMatrixCompressedCSR<T>::multiply_rows(const std::vector<T> &v, std::vector<T> &result, ValueAt value_at) const
+{
+    // same decoding as decode_row(), written out here so that sum stays in a register
+    // (through the visit callback it is updated in memory for every element)
+    const unsigned char *byte = col_bytes.data();
+    const T *x = v.data();
+    for (unsigned int i = 0; i < n_rows; ++i)
+    {
+        T sum = 0;
+        unsigned int k = row_idx[i];
+        const unsigned int end = row_idx[i + 1];
+        if (k < end)
+        {
+            unsigned char width = end - k > 1 ? *byte++ : COLUMNS_8;
+            unsigned int col = read_varint(byte);
+            sum = sum + value_at(k) * x[col];
+            ++k;
+
+            // rows rarely change width, so this branch is well predicted
+            switch (width)
+            {
+            case COLUMNS_8:
+                for (; k < end; ++k, ++byte)
+                {
+                    col += byte[0];
+                    sum = sum + value_at(k) * x[col];
+                }
+                break;
+            case COLUMNS_16:
+                for (; k < end; ++k, byte += 2)
+                {
+                    col += byte[0] | static_cast<unsigned int>(byte[1]) << 8;
+                    sum = sum + value_at(k) * x[col];
+                }
+                break;
+            case COLUMNS_24:
+                for (; k < end; ++k, byte += 3)
+                {
+                    col += byte[0] | static_cast<unsigned int>(byte[1]) << 8 | static_cast<unsigned int>(byte[2]) << 16;
+                    sum = sum + value_at(k) * x[col];
+                }
+                break;
+            default:
+                for (; k < end; ++k)
+                {
+                    col += read_varint(byte);
+                    sum = sum + value_at(k) * x[col];
+                }
+            }
+        }
+        result[i] = sum;
+    }
+}
+
+template <typename T>
+void SparseMatrixCompressedCSR<T>::multiply(const std::vector<T> &v, std::vector<T> &result) const
+{
+    // vectors must be of compatible size
+    assert(v.size() == n_cols && result.size() == n_rows);
+
+    // choose the value decoding once, outside of the loops
+    switch (encoding)
+    {
+    case ValueEncoding::DICTIONARY:
+    {
+        const T *dictionary = values.data();
+        const unsigned char *ids = value_ids.data();
+        multiply_rows(v, result, [dictionary, ids](unsigned int k)
+                      { return dictionary[ids[k]]; });
+        break;
+    }
+    case ValueEncoding::PATTERN:
+    {
+        const T value = values.empty() ? ZERO : values[0];
+        multiply_rows(v, result, [value](unsigned int)
+                      { return value; });
+        break;
+    }
+    default:
+    {
+        const T *raw = values.data();
+        multiply_rows(v, result, [raw](unsigned int k)
+                      { return raw[k]; });
+    }
+    }
+}
+
+template <typename T>
+std::vector<T> SparseMatrixCompressedCSR<T>::operator*(const std::vector<T> &v) const
+{
+    std::vector<T> result(n_rows, 0);
+    multiply(v, result);
+    return result;
+}
+
+template <typename T>
+SparseMatrixCSR<T> SparseMatrixCompressedCSR<T>::to_CSR() const
+{
+    std::vector<T> decoded_values;
+    std::vector<unsigned int> decoded_cols;
+    decoded_values.reserve(get_nnz());
+    decoded_cols.reserve(get_nnz());
+
+    const unsigned char *byte = col_bytes.data();
+    for (unsigned int i = 0; i < n_rows; ++i)
+    {
+        decode_row(byte, row_idx[i + 1] - row_idx[i], [&](unsigned int k, unsigned int col)
+                   {
+                       decoded_cols.push_back(col);
+                       unsigned int j = row_idx[i] + k;
+                       switch (encoding)
+                       {
+                       case ValueEncoding::RAW:
+                           decoded_values.push_back(values[j]);
+                           break;
+                       case ValueEncoding::DICTIONARY:
+                           decoded_values.push_back(values[value_ids[j]]);
+                           break;
+                       case ValueEncoding::PATTERN:
+                           decoded_values.push_back(values[0]);
+                           break;
+                       } });
+    }
+
+    SparseMatrixCSR<T> converted(decoded_values, decoded_cols, row_idx, n_rows, n_cols);
+    return converted;
+}
+
+// explicit instantiation for the class using int and double
+template class SparseMatrixCompressedCSR<int>;
+template class SparseMatrixCompressedCSR<double>;
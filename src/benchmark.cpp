@@ -0,0 +1,251 @@
+#include "../include/SparseMatrixCompressedCSR.hpp"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+
+// Compares plain and compressed CSR matrix-vector products.
+// Usage: ./sparse_matrix_benchmark [file.mtx ...]
+// Without arguments some generated matrices are used; Matrix Market files (coordinate format) can be given instead.
+
+// reads a Matrix Market coordinate file into a CSR matrix (pattern matrices get unit values)
+SparseMatrixCSR<double> read_matrix_market(const std::string &path)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        std::cerr << "Cannot open " << path << std::endl;
+        std::exit(1);
+    }
+
+    // header: %%MatrixMarket matrix <format> <field> <symmetry> (case-insensitive)
+    std::string line;
+    std::getline(file, line);
+    std::transform(line.begin(), line.end(), line.begin(), [](unsigned char c)
+                   { return std::tolower(c); });
+    std::string banner, object, format, field, symmetry;
+    std::istringstream(line) >> banner >> object >> format >> field >> symmetry;
+    if (banner != "%%matrixmarket" || object != "matrix" || format != "coordinate" ||
+        (field != "real" && field != "integer" && field != "pattern") ||
+        (symmetry != "general" && symmetry != "symmetric" && symmetry != "skew-symmetric"))
+    {
+        std::cerr << path << ": only real, integer or pattern coordinate matrices "
+                  << "(general, symmetric or skew-symmetric) are supported" << std::endl;
+        std::exit(1);
+    }
+    bool pattern = field == "pattern";
+
+    while (std::getline(file, line) && (line.empty() || line[0] == '%')) // skip the comments
+    {
+    }
+    unsigned int n_rows, n_cols, n_entries;
+    if (!file || !(std::istringstream(line) >> n_rows >> n_cols >> n_entries))
+    {
+        std::cerr << path << ": missing matrix size" << std::endl;
+        std::exit(1);
+    }
+
+    // count the elements of each row, then place them (entries can be in any order)
+    std::vector<unsigned int> entry_rows, entry_cols;
+    std::vector<double> entry_values;
+    for (unsigned int k = 0; k < n_entries; ++k)
+    {
+        unsigned int row, col;
+        double value = 1;
+        file >> row >> col;
+        if (!pattern)
+        {
+            file >> value;
+        }
+        if (!file || row == 0 || col == 0 || row > n_rows || col > n_cols)
+        {
+            std::cerr << path << ": invalid or missing entry " << k + 1 << std::endl;
+            std::exit(1);
+        }
+        entry_rows.push_back(row - 1); // Matrix Market is 1-based
+        entry_cols.push_back(col - 1);
+        entry_values.push_back(value);
+        if (symmetry != "general" && row != col) // only one triangle is stored
+        {
+            entry_rows.push_back(col - 1);
+            entry_cols.push_back(row - 1);
+            entry_values.push_back(symmetry == "skew-symmetric" ? -value : value);
+        }
+    }
+
+    std::vector<unsigned int> row_idx(n_rows + 1, 0);
+    for (unsigned int row : entry_rows)
+    {
+        ++row_idx[row + 1];
+    }
+    for (unsigned int i = 0; i < n_rows; ++i)
+    {
+        row_idx[i + 1] += row_idx[i];
+    }
+    std::vector<unsigned int> cols(entry_cols.size());
+    std::vector<double> values(entry_values.size());
+    std::vector<unsigned int> next(row_idx.begin(), row_idx.end() - 1);
+    for (unsigned int k = 0; k < entry_rows.size(); ++k)
+    {
+        unsigned int position = next[entry_rows[k]]++;
+        cols[position] = entry_cols[k];
+        values[position] = entry_values[k];
+    }
+
+    // sort the columns inside each row
+    for (unsigned int i = 0; i < n_rows; ++i)
+    {
+        std::vector<std::pair<unsigned int, double>> row;
+        for (unsigned int j = row_idx[i]; j < row_idx[i + 1]; ++j)
+        {
+            row.emplace_back(cols[j], values[j]);
+        }
+        std::sort(row.begin(), row.end());
+        for (unsigned int j = 0; j < row.size(); ++j)
+        {
+            cols[row_idx[i] + j] = row[j].first;
+            values[row_idx[i] + j] = row[j].second;
+        }
+    }
+
+    return SparseMatrixCSR<double>(values, cols, row_idx, n_rows, n_cols);
+}
+
+// 5-point Laplacian on a side x side grid: only two distinct values
+SparseMatrixCSR<double> make_stencil(unsigned int side)
+{
+    std::vector<double> values;
+    std::vector<unsigned int> cols;
+    std::vector<unsigned int> row_idx{0};
+    for (unsigned int y = 0; y < side; ++y)
+    {
+        for (unsigned int x = 0; x < side; ++x)
+        {
+            unsigned int i = y * side + x;
+            if (y > 0)
+            {
+                cols.push_back(i - side);
+                values.push_back(-1);
+            }
+            if (x > 0)
+            {
+                cols.push_back(i - 1);
+                values.push_back(-1);
+            }
+            cols.push_back(i);
+            values.push_back(4);
+            if (x + 1 < side)
+            {
+                cols.push_back(i + 1);
+                values.push_back(-1);
+            }
+            if (y + 1 < side)
+            {
+                cols.push_back(i + side);
+                values.push_back(-1);
+            }
+            row_idx.push_back(cols.size());
+        }
+    }
+    return SparseMatrixCSR<double>(values, cols, row_idx, side * side, side * side);
+}
+
+// n x n matrix with per_row elements in each row, clustered around the diagonal;
+// unit_weights gives an adjacency-like pattern matrix, otherwise values are random
+SparseMatrixCSR<double> make_banded(unsigned int n, unsigned int per_row, unsigned int bandwidth, bool unit_weights)
+{
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> random_value(-1, 1);
+    std::vector<double> values;
+    std::vector<unsigned int> cols;
+    std::vector<unsigned int> row_idx{0};
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        unsigned int first = i > bandwidth / 2 ? i - bandwidth / 2 : 0;
+        unsigned int last = std::min(n, first + bandwidth);
+        std::vector<unsigned int> row;
+        std::uniform_int_distribution<unsigned int> random_col(first, last - 1);
+        while (row.size() < std::min(per_row, last - first))
+        {
+            unsigned int col = random_col(generator);
+            if (std::find(row.begin(), row.end(), col) == row.end())
+            {
+                row.push_back(col);
+            }
+        }
+        std::sort(row.begin(), row.end());
+        for (unsigned int col : row)
+        {
+            cols.push_back(col);
+            values.push_back(unit_weights ? 1 : random_value(generator));
+        }
+        row_idx.push_back(cols.size());
+    }
+    return SparseMatrixCSR<double>(values, cols, row_idx, n, n);
+}
+
+// average time of one product, in microseconds
+// (result is allocated once, so that only the kernel is timed and not the allocation done by operator*)
+template <typename Matrix>
+double time_product(const Matrix &m, const std::vector<double> &v, std::vector<double> &result)
+{
+    const unsigned int repetitions = 50;
+    result.assign(m.get_n_rows(), 0);
+    m.multiply(v, result); // warm-up
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned int r = 0; r < repetitions; ++r)
+    {
+        m.multiply(v, result);
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / repetitions;
+}
+
+void run(const std::string &name, const SparseMatrixCSR<double> &csr)
+{
+    SparseMatrixCompressedCSR<double> compressed = csr.to_compressed();
+
+    std::vector<double> v(csr.get_n_cols());
+    for (unsigned int i = 0; i < v.size(); ++i)
+    {
+        v[i] = 1.0 / (i + 1);
+    }
+    std::vector<double> result_csr, result_compressed;
+    double time_csr = time_product(csr, v, result_csr);
+    double time_compressed = time_product(compressed, v, result_compressed);
+    if (result_csr != result_compressed)
+    {
+        std::cerr << name << ": compressed product differs from plain CSR" << std::endl;
+        std::exit(1);
+    }
+
+    const char *encodings[] = {"raw", "dictionary", "pattern"};
+    std::cout << name << " (" << csr.get_n_rows() << "x" << csr.get_n_cols() << ", nnz " << csr.get_nnz()
+              << ", values " << encodings[static_cast<int>(compressed.get_value_encoding())] << ")" << std::endl
+              << "    bytes: " << csr.get_size_in_bytes() << " -> " << compressed.get_size_in_bytes()
+              << " (ratio " << static_cast<double>(csr.get_size_in_bytes()) / compressed.get_size_in_bytes() << ")" << std::endl
+              << "    time:  " << time_csr << " us -> " << time_compressed << " us"
+              << " (speedup " << time_csr / time_compressed << ")" << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 1)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            run(argv[i], read_matrix_market(argv[i]));
+        }
+        return 0;
+    }
+
+    run("5-point stencil", make_stencil(1500));
+    run("banded adjacency", make_banded(2000000, 8, 64, true));
+    run("banded random values", make_banded(2000000, 8, 64, false));
+    run("scattered adjacency", make_banded(2000000, 8, 2000000, true));
+    return 0;
+}
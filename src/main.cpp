@@ -1,5 +1,9 @@
-#include "../include/SparseMatrixCSR.hpp"
+#include "../include/SparseMatrixCompressedCSR.hpp"
 #include <cassert>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <sstream>
 
 int main()
 {
@@ -160,5 +164,152 @@ int main()
 
     std::cout << "Additional tests for the matrix-vector product have been completed successfully" << std::endl;
 
+    // compressed CSR: each value encoding must give the same elements and products as plain CSR
+    std::vector<double> values_dictionary{2, 1, 2, 2, 1, 2};
+    std::vector<double> values_pattern{1, 1, 1, 1, 1, 1};
+    SparseMatrixCSR csr_raw(values, columns, row_idx, 4, 300);
+    SparseMatrixCSR csr_dictionary(values_dictionary, columns, row_idx, 4, 300);
+    SparseMatrixCSR csr_pattern(values_pattern, columns, row_idx, 4, 300);
+    for (unsigned int j = 0; j < 300; ++j) // more distinct values than a dictionary can hold
+    {
+        csr_raw(3, j + 1) = j + 0.5;
+    }
+    csr_raw(1, 300) = 8; // column deltas that need two bytes
+    csr_dictionary(1, 300) = 2;
+    csr_pattern(1, 300) = 1;
+    SparseMatrixCompressedCSR compressed_raw = csr_raw.to_compressed();
+    SparseMatrixCompressedCSR compressed_dictionary = csr_dictionary.to_compressed();
+    SparseMatrixCompressedCSR compressed_pattern = csr_pattern.to_compressed();
+    assert(compressed_raw.get_value_encoding() == SparseMatrixCompressedCSR<double>::ValueEncoding::RAW);
+    assert(compressed_dictionary.get_value_encoding() == SparseMatrixCompressedCSR<double>::ValueEncoding::DICTIONARY);
+    assert(compressed_pattern.get_value_encoding() == SparseMatrixCompressedCSR<double>::ValueEncoding::PATTERN);
+
+    // values are compared exactly: NaN keeps its own id and -0.0 is not merged with +0.0
+    std::vector<double> special_values{std::numeric_limits<double>::quiet_NaN(), -0.0, 0.0, 1, 1, 1, 1, 1, 1, 1};
+    std::vector<unsigned int> special_cols{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    std::vector<unsigned int> special_row_idx{0, 10};
+    SparseMatrixCSR csr_special(special_values, special_cols, special_row_idx, 1, 10);
+    SparseMatrixCompressedCSR compressed_special = csr_special.to_compressed();
+    assert(compressed_special.get_value_encoding() == SparseMatrixCompressedCSR<double>::ValueEncoding::DICTIONARY);
+    assert(std::isnan(compressed_special(1, 1)) && compressed_special(1, 4) == 1);
+    assert(std::signbit(compressed_special(1, 2)) && !std::signbit(compressed_special(1, 3)));
+    std::vector<double> ones(10, 1);
+    assert(std::isnan((compressed_special * ones)[0]));
+    assert(compressed_raw.get_nnz() == 307 && compressed_raw.get_n_rows() == 4 && compressed_raw.get_n_cols() == 300);
+    assert(compressed_dictionary.get_size_in_bytes() < csr_dictionary.get_size_in_bytes());
+    assert(compressed_pattern.get_size_in_bytes() < compressed_dictionary.get_size_in_bytes());
+
+    std::vector<double> v300;
+    for (unsigned int i = 0; i < 300; ++i)
+    {
+        v300.push_back(i + 1);
+    }
+    const SparseMatrixCSR<double> *plain[] = {&csr_raw, &csr_dictionary, &csr_pattern};
+    const SparseMatrixCompressedCSR<double> *compressed[] = {&compressed_raw, &compressed_dictionary, &compressed_pattern};
+    for (unsigned int m = 0; m < 3; ++m)
+    {
+        for (unsigned int i = 0; i < 4; ++i)
+        {
+            for (unsigned int j = 0; j < 300; ++j)
+            {
+                assert((*compressed[m])(i + 1, j + 1) == (*plain[m])(i + 1, j + 1));
+            }
+        }
+        assert((*compressed[m]) * v300 == (*plain[m]) * v300);
+        assert(compressed[m]->to_CSR() * v300 == (*plain[m]) * v300);
+    }
+
+    // column distances of every width: 8 bits, 16 bits, 24 bits, varints (up to 5 bytes)
+    std::vector<double> wide_values{1, 2, 3, 4, 5, 6, 7};
+    std::vector<unsigned int> wide_cols{0, 200, 60000, 5000000, 400000000, 10, 300000010};
+    std::vector<unsigned int> wide_row_idx{0, 2, 4, 5, 7};
+    SparseMatrixCSR csr_wide(wide_values, wide_cols, wide_row_idx, 4, 400000001);
+    SparseMatrixCompressedCSR compressed_wide = csr_wide.to_compressed();
+    assert(compressed_wide(1, 201) == 2 && compressed_wide(2, 60001) == 3 && compressed_wide(2, 5000001) == 4);
+    assert(compressed_wide(3, 400000001) == 5 &&
+           compressed_wide(4, 11) == 6 &&
+           compressed_wide(4, 300000011) == 7 &&
+           compressed_wide(4, 2) == 0);
+    SparseMatrixCSR csr_wide_decoded = compressed_wide.to_CSR();
+    for (unsigned int i = 0; i < 7; ++i)
+    {
+        unsigned int row = i < 2 ? 0 : (i < 4 ? 1 : (i < 5 ? 2 : 3));
+        assert(csr_wide_decoded(row + 1, wide_cols[i] + 1) == wide_values[i]);
+    }
+
+    // a dictionary is not used when it takes more space than the values themselves
+    std::vector<int> distinct_values;
+    std::vector<unsigned int> distinct_cols;
+    std::vector<unsigned int> distinct_row_idx{0};
+    for (unsigned int i = 0; i < 200; ++i)
+    {
+        distinct_values.push_back(i + 1);
+        distinct_cols.push_back(0);
+        distinct_row_idx.push_back(i + 1);
+    }
+    SparseMatrixCSR csr_distinct(distinct_values, distinct_cols, distinct_row_idx, 200, 1);
+    SparseMatrixCompressedCSR compressed_distinct = csr_distinct.to_compressed();
+    assert(compressed_distinct.get_value_encoding() == SparseMatrixCompressedCSR<int>::ValueEncoding::RAW);
+    assert(compressed_distinct.get_size_in_bytes() <= csr_distinct.get_size_in_bytes());
+    std::cout << "Compressed CSR matrices match their plain CSR counterparts" << std::endl;
+
+    // dense printing: every cell is as wide as the longest number, plus one space
+    std::ostringstream dense_double, dense_int;
+    dense_double << a_coo;
+    assert(dense_double.str() == "0   0   3.1 0   4   \n"
+                                 "0   0   3.3 0   7.4 \n"
+                                 "0   0   0   0   0   \n"
+                                 "0   2   0   6   0   ");
+    std::ostringstream dense_fixed;
+    dense_fixed << std::fixed << std::setprecision(2) << a_coo;
+    assert(dense_fixed.str() == "0.00 0.00 3.10 0.00 4.00 \n"
+                                "0.00 0.00 3.30 0.00 7.40 \n"
+                                "0.00 0.00 0.00 0.00 0.00 \n"
+                                "0.00 2.00 0.00 6.00 0.00 ");
+    std::vector<int> dense_values{10, 4, 5};
+    std::vector<unsigned int> dense_rows{0, 0, 1};
+    std::vector<unsigned int> dense_cols{0, 2, 1};
+    SparseMatrixCOO coo_two_digits(dense_values, dense_rows, dense_cols);
+    coo_two_digits.print_dense(dense_int);
+    assert(dense_int.str() == "10 0  4  \n"
+                              "0  5  0  ");
+
+    // sparse and summary printing
+    std::ostringstream sparse_coo, sparse_csr;
+    a_coo.print_sparse(sparse_coo);
+    b_csr.print_sparse(sparse_csr);
+    assert(sparse_coo.str() == "%%MatrixMarket matrix coordinate real general\n"
+                               "4 5 6\n"
+                               "1 3 3.1\n1 5 4\n2 3 3.3\n2 5 7.4\n4 2 2\n4 4 6");
+    assert(sparse_csr.str() == "%%MatrixMarket matrix coordinate real general\n"
+                               "4 5 6\n"
+                               "1 3 3.1\n1 5 1.2\n2 3 5\n2 5 7.4\n4 2 2\n4 4 6");
+
+    // a matrix too big to be printed cell by cell
+    std::vector<unsigned int> big_row_idx{0};
+    std::vector<unsigned int> big_cols;
+    std::vector<int> big_values;
+    for (unsigned int i = 0; i < 1000; ++i)
+    {
+        for (unsigned int j = 0; j < i % 5; ++j)
+        {
+            big_cols.push_back(j);
+            big_values.push_back(1);
+        }
+        big_row_idx.push_back(big_cols.size());
+    }
+    SparseMatrixCSR big_csr(big_values, big_cols, big_row_idx, 1000, 1000);
+    std::ostringstream big_printed, big_summary;
+    big_printed << big_csr;
+    big_csr.print_summary(big_summary);
+    assert(big_printed.str() == big_summary.str());
+    assert(big_summary.str() == "1000 x 1000 sparse matrix with 2000 nonzero elements\n"
+                                "rows by number of nonzero elements:\n"
+                                "    0: 200\n"
+                                "    1: 200\n"
+                                "    2-3: 400\n"
+                                "    4-7: 200");
+    std::cout << "Sparse and summary printing work" << std::endl;
+
     return 0;
 }
\ No newline at end of file